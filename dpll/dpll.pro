@@ -14,10 +14,21 @@ DEFINES += QT_DEPRECATED_WARNINGS
 # You can also select to disable deprecated APIs only up to a certain version of Qt.
 #DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
 
+# Debug builds print every step of the solver (decisions, propagations, conflicts, ...) to standard output.
+CONFIG(debug, debug|release): DEFINES += DEBUG
+
+# Uncomment the following line to build solver with 16-bit literals (for instances with at most 32767 variables).
+#DEFINES += DPLL_SMALL_LITERALS
+
 SOURCES += \
         main.cpp \
     solver.cpp \
-    partial_valuation.cpp
+    partial_valuation.cpp \
+    local_search.cpp \
+    protocol.cpp \
+    result_cache.cpp \
+    server.cpp \
+    load_generator.cpp
 
 # Default rules for deployment.
 qnx: target.path = /tmp/$${TARGET}/bin
@@ -26,4 +37,10 @@ else: unix:!android: target.path = /opt/$${TARGET}/bin
 
 HEADERS += \
     solver.h \
-    partial_valuation.h
+    partial_valuation.h \
+    local_search.h \
+    solver_policies.h \
+    protocol.h \
+    result_cache.h \
+    server.h \
+    load_generator.h
@@ -0,0 +1,116 @@
+#include "load_generator.h"
+#include "protocol.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+static int connectTo(const std::string &socketPath) {
+    sockaddr_un address{};
+    if (socketPath.size() >= sizeof(address.sun_path)){
+        throw std::runtime_error{"Socket path is too long. (load generator)"};
+    }
+    address.sun_family = AF_UNIX;
+    std::strcpy(address.sun_path, socketPath.c_str());
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0){
+        if (fd >= 0){
+            close(fd);
+        }
+        throw std::runtime_error{"Can't connect to socket " + socketPath};
+    }
+    return fd;
+}
+
+unsigned runLoadGenerator(const std::string &socketPath, const std::vector<std::string> &dimacsFiles,
+                          unsigned nRequests, unsigned nConnections, std::ostream &out) {
+
+    std::vector<std::string> formulas;
+    for (const std::string &path : dimacsFiles){
+        std::ifstream dimacsStream(path);
+        if (!dimacsStream.is_open()){
+            throw std::runtime_error{"Bad path to dimacs file. (load generator)"};
+        }
+        std::ostringstream content;
+        content << dimacsStream.rdbuf();
+        formulas.push_back(content.str());
+    }
+    if (formulas.empty() || nConnections == 0){
+        throw std::runtime_error{"Load generator needs at least one dimacs file and one connection."};
+    }
+
+    std::atomic<unsigned> nextRequest{0};
+    std::atomic<unsigned> nFailed{0}; /* requests with error response */
+    std::atomic<unsigned> nCached{0};
+    std::vector<double> latencies; /* in milliseconds */
+    std::mutex latenciesMutex;
+
+    auto client = [&](){
+        int fd;
+        try {
+            fd = connectTo(socketPath);
+        }
+        catch (const std::exception &e) {
+            std::cerr << e.what() << std::endl;
+            return;
+        }
+        std::vector<double> clientLatencies;
+        std::string response;
+
+        unsigned request;
+        while ((request = nextRequest++) < nRequests){
+            auto start = std::chrono::steady_clock::now();
+            if (!writeFrame(fd, formulas[request % formulas.size()]) || !readFrame(fd, response) || response.size() < 2){
+                break;
+            }
+            std::chrono::duration<double, std::milli> latency = std::chrono::steady_clock::now() - start;
+            clientLatencies.push_back(latency.count());
+
+            if (static_cast<ResponseStatus>(response[0]) == ResponseStatus::Error){
+                nFailed++;
+            }
+            if (response[1] & CachedResponse){
+                nCached++;
+            }
+        }
+        close(fd);
+
+        std::lock_guard<std::mutex> lock(latenciesMutex);
+        latencies.insert(latencies.end(), clientLatencies.cbegin(), clientLatencies.cend());
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> clients;
+    for (unsigned i = 0; i < nConnections; i++){
+        clients.emplace_back(client);
+    }
+    for (std::thread &c : clients){
+        c.join();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    /* Requests without response (connection failed, or they were never sent) are failed too */
+    nFailed += nRequests - latencies.size();
+
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&latencies](double p){
+        return latencies.empty() ? 0.0 : latencies[std::min(latencies.size() - 1, static_cast<std::size_t>(p * latencies.size()))];
+    };
+
+    out << "Requests: " << latencies.size() << " (failed: " << nFailed << ", cached: " << nCached << ")" << std::endl;
+    out << "Throughput: " << latencies.size() / elapsed.count() << " requests/s" << std::endl;
+    out << "Latency p50: " << percentile(0.5) << " ms, p99: " << percentile(0.99) << " ms" << std::endl;
+
+    return nFailed;
+}
@@ -0,0 +1,18 @@
+#ifndef LOAD_GENERATOR_H
+#define LOAD_GENERATOR_H
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief runLoadGenerator - Client of solver server (see Server) that measures its performance.
+ * It opens nConnections connections to socket and sends nRequests formulas in total, taking DIMACS files in turn.
+ * Every connection sends next request when it receives response to the previous one.
+ * Throughput and p50/p99 latency of requests are written to out.
+ * @return - number of requests that failed (with error response or without any response)
+ */
+unsigned runLoadGenerator(const std::string &socketPath, const std::vector<std::string> &dimacsFiles,
+                          unsigned nRequests, unsigned nConnections, std::ostream &out);
+
+#endif // LOAD_GENERATOR_H
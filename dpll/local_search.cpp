@@ -0,0 +1,174 @@
+#include "local_search.h"
+
+#include <algorithm>
+#include <cmath>
+
+/* ProbSAT parameters: weight of variable is BreakBase^(-break count) */
+static constexpr double BreakBase = 2.5;
+static constexpr unsigned MaxBreakWeight = 64;
+
+LocalSearch::LocalSearch(const CNFFormula &formula, unsigned nVars, unsigned seed)
+    : _formula(formula), _nVars(nVars), _generator(seed), _occurrences(2 * (nVars + 1)),
+      _tautology(formula.size(), false), _hasEmptyClause(false)
+{
+    for (unsigned c = 0; c < _formula.size(); c++){
+        Clause literals = _formula[c];
+        std::sort(literals.begin(), literals.end());
+        literals.erase(std::unique(literals.begin(), literals.end()), literals.end());
+
+        if (literals.empty()){
+            _hasEmptyClause = true;
+        }
+        for (Literal lit : literals){
+            if (std::binary_search(literals.cbegin(), literals.cend(), -lit)){
+                _tautology[c] = true;
+            }
+        }
+        if (!_tautology[c]){
+            for (Literal lit : literals){
+                _occurrences[occurrenceIndex(lit)].push_back(c);
+            }
+        }
+    }
+
+    for (unsigned b = 0; b <= MaxBreakWeight; b++){
+        _breakWeight.push_back(std::pow(BreakBase, -static_cast<double>(b)));
+    }
+}
+
+std::optional<PartialValuation> LocalSearch::run(unsigned long maxFlips) {
+    std::vector<bool> initial(_nVars + 1);
+    std::bernoulli_distribution coin;
+    for (unsigned var = 1; var <= _nVars; var++){
+        initial[var] = coin(_generator);
+    }
+    return run(maxFlips, initial);
+}
+
+std::optional<PartialValuation> LocalSearch::run(unsigned long maxFlips, const std::vector<bool> &initial) {
+    if (_hasEmptyClause){
+        return {};
+    }
+
+    initialize(initial);
+    _bestValuation = _valuation;
+    std::size_t bestFalseCount = _falseClauses.size();
+
+    for (unsigned long i = 0; i < maxFlips && !_falseClauses.empty(); i++){
+        std::uniform_int_distribution<std::size_t> pick(0, _falseClauses.size() - 1);
+        unsigned c = _falseClauses[pick(_generator)];
+        flip(pickVariable(_formula[c]));
+
+        if (_falseClauses.size() < bestFalseCount){
+            bestFalseCount = _falseClauses.size();
+            _bestValuation = _valuation;
+        }
+    }
+
+    if (!_falseClauses.empty()){
+        return {};
+    }
+    return toPartialValuation();
+}
+
+const std::vector<bool> &LocalSearch::bestValuation() const {
+    return _bestValuation;
+}
+
+void LocalSearch::initialize(const std::vector<bool> &valuation) {
+    _valuation = valuation;
+    _valuation.resize(_nVars + 1, true);
+
+    _trueCount.assign(_formula.size(), 0);
+    _trueSum.assign(_formula.size(), 0);
+    _breakCount.assign(_nVars + 1, 0);
+    _falseClauses.clear();
+    _falseClausePosition.assign(_formula.size(), -1);
+
+    for (unsigned var = 1; var <= _nVars; var++){
+        Literal lit = _valuation[var] ? static_cast<Literal>(var) : -static_cast<Literal>(var);
+        for (unsigned c : _occurrences[occurrenceIndex(lit)]){
+            _trueCount[c]++;
+            _trueSum[c] ^= static_cast<Literal>(var);
+        }
+    }
+
+    for (unsigned c = 0; c < _formula.size(); c++){
+        if (_tautology[c]){
+            continue;
+        }
+        if (_trueCount[c] == 0){
+            addFalseClause(c);
+        }
+        else if (_trueCount[c] == 1){
+            _breakCount[_trueSum[c]]++;
+        }
+    }
+}
+
+void LocalSearch::flip(Literal var) {
+    _valuation[var] = !_valuation[var];
+    Literal becameTrue = _valuation[var] ? var : -var;
+
+    /* Clauses that contain literal that became true */
+    for (unsigned c : _occurrences[occurrenceIndex(becameTrue)]){
+        if (_trueCount[c] == 0){
+            removeFalseClause(c);
+            _breakCount[var]++;
+        }
+        else if (_trueCount[c] == 1){
+            _breakCount[_trueSum[c]]--;
+        }
+        _trueCount[c]++;
+        _trueSum[c] ^= var;
+    }
+
+    /* Clauses that contain literal that became false */
+    for (unsigned c : _occurrences[occurrenceIndex(-becameTrue)]){
+        _trueCount[c]--;
+        _trueSum[c] ^= var;
+        if (_trueCount[c] == 0){
+            addFalseClause(c);
+            _breakCount[var]--;
+        }
+        else if (_trueCount[c] == 1){
+            _breakCount[_trueSum[c]]++;
+        }
+    }
+}
+
+Literal LocalSearch::pickVariable(const Clause &c) {
+    std::vector<double> weights;
+    weights.reserve(c.size());
+    for (Literal lit : c){
+        weights.push_back(_breakWeight[std::min(_breakCount[std::abs(lit)], MaxBreakWeight)]);
+    }
+    std::discrete_distribution<std::size_t> pick(weights.cbegin(), weights.cend());
+    return std::abs(c[pick(_generator)]);
+}
+
+unsigned LocalSearch::occurrenceIndex(Literal lit) const {
+    return 2 * std::abs(lit) + (lit < 0 ? 1 : 0);
+}
+
+void LocalSearch::addFalseClause(unsigned c) {
+    _falseClausePosition[c] = _falseClauses.size();
+    _falseClauses.push_back(c);
+}
+
+void LocalSearch::removeFalseClause(unsigned c) {
+    unsigned last = _falseClauses.back();
+    _falseClauses[_falseClausePosition[c]] = last;
+    _falseClausePosition[last] = _falseClausePosition[c];
+    _falseClauses.pop_back();
+    _falseClausePosition[c] = -1;
+}
+
+PartialValuation LocalSearch::toPartialValuation() const {
+    PartialValuation valuation;
+    valuation.reset(_nVars);
+    for (unsigned var = 1; var <= _nVars; var++){
+        valuation.push(_valuation[var] ? static_cast<Literal>(var) : -static_cast<Literal>(var));
+    }
+    return valuation;
+}
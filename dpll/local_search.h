@@ -0,0 +1,93 @@
+#ifndef LOCAL_SEARCH_H
+#define LOCAL_SEARCH_H
+
+#include "partial_valuation.h"
+
+#include <optional>
+#include <random>
+#include <vector>
+
+/**
+ * @brief The LocalSearch class - ProbSAT stochastic local search over clauses of a CNF formula.
+ * Starting from a total valuation, it repeatedly picks a random false clause and flips one of its variables,
+ * chosen with probability that decreases exponentially with the number of clauses the flip would make false (break count).
+ * It can only prove satisfiability: if no satisfying valuation is found within given number of flips, nothing is returned.
+ */
+
+class LocalSearch {
+
+public:
+    /**
+     * @brief LocalSearch - constructor
+     * @param formula - clauses on which search is done (they are not copied, so formula must not change during search)
+     * @param nVars - number of variables
+     * @param seed - seed of random number generator
+     */
+    LocalSearch(const CNFFormula &formula, unsigned nVars, unsigned seed = 0);
+
+
+    /**
+     * @brief run - Local search from random valuation.
+     * @param maxFlips - maximal number of flips
+     * @return - total valuation if it satisfies formula, otherwise nothing
+     */
+    std::optional<PartialValuation> run(unsigned long maxFlips);
+
+    /**
+     * @brief run - Local search from given valuation.
+     * @param initial - initial value of every variable (indexed by variable, true if variable is true)
+     */
+    std::optional<PartialValuation> run(unsigned long maxFlips, const std::vector<bool> &initial);
+
+
+    /**
+     * @brief bestValuation - Returns valuation with least false clauses found during last run (indexed by variable).
+     */
+    const std::vector<bool> &bestValuation() const;
+
+private:
+
+    /**
+     * @brief initialize - Sets valuation and computes true literal counts, break counts and list of false clauses.
+     */
+    void initialize(const std::vector<bool> &valuation);
+
+    /**
+     * @brief flip - Flips value of variable var and updates true literal counts, break counts and list of false clauses.
+     */
+    void flip(Literal var);
+
+    /**
+     * @brief pickVariable - Picks variable of false clause c that will be flipped.
+     */
+    Literal pickVariable(const Clause &c);
+
+    unsigned occurrenceIndex(Literal lit) const;
+
+    void addFalseClause(unsigned c);
+
+    void removeFalseClause(unsigned c);
+
+    PartialValuation toPartialValuation() const;
+
+
+    const CNFFormula &_formula;
+    unsigned _nVars;
+    std::mt19937 _generator;
+
+    std::vector<std::vector<unsigned>> _occurrences; /* clauses in which literal occurs, indexed by occurrenceIndex */
+    std::vector<bool> _tautology; /* marks clauses that contain literal and its negation, those are skipped */
+    bool _hasEmptyClause;
+
+    std::vector<bool> _valuation;
+    std::vector<unsigned> _trueCount; /* number of true literals in clause */
+    std::vector<Literal> _trueSum; /* xor of variables of true literals in clause, it is the only true variable when _trueCount is 1 */
+    std::vector<unsigned> _breakCount; /* number of clauses in which variable is the only true one */
+    std::vector<unsigned> _falseClauses;
+    std::vector<int> _falseClausePosition; /* position of clause in _falseClauses, or -1 */
+
+    std::vector<bool> _bestValuation;
+    std::vector<double> _breakWeight; /* probability weight of variable with given break count */
+};
+
+#endif // LOCAL_SEARCH_H
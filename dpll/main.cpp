@@ -2,34 +2,86 @@
 #include <iostream>
 #include <fstream>
 #include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include "solver.h"
+#include "server.h"
+#include "load_generator.h"
 
+static constexpr unsigned long LocalSearchMaxFlips = 10000000;
+static constexpr std::size_t ServerCacheCapacity = 100000;
+
+/**
+ * @brief solveAndPrint - Solves formula from dimacsStream using solver configuration SolverType and prints the result.
+ */
+template <typename SolverType>
+static void solveAndPrint(std::istream &dimacsStream, bool localSearch)
+{
+    SolverType s{dimacsStream};
+
+    OptionalPartialValuation solution = localSearch ? s.solveLocalSearch(LocalSearchMaxFlips) : s.solve();
+    if (solution)
+    {
+        std::cout << "SAT" << std::endl;
+        std::cout << solution.value() << std::endl;
+    }
+    else if (localSearch)
+    {
+        std::cout << "UNKNOWN" << std::endl;
+    }
+    else
+    {
+        std::cout << "UNSAT" << std::endl;
+    }
+}
 
 int main(int argc, char *argv[])
 {
+    /* Usage: dpll --serve socket_path [workers]
+       Server and load generator modes don't need Qt application */
+    if (argc >= 3 && std::string{argv[1]} == "--serve"){
+        unsigned nWorkers = argc > 3 ? std::stoul(argv[3]) : std::max(1u, std::thread::hardware_concurrency());
+
+        Server server{argv[2], nWorkers, ServerCacheCapacity};
+        std::cerr << "Listening on " << argv[2] << " with " << nWorkers << " workers" << std::endl;
+        server.run();
+        return 0;
+    }
+
+    /* Usage: dpll --load socket_path requests connections dimacs_file... */
+    if (argc >= 6 && std::string{argv[1]} == "--load"){
+        std::vector<std::string> dimacsFiles(argv + 5, argv + argc);
+        return runLoadGenerator(argv[2], dimacsFiles, std::stoul(argv[3]), std::stoul(argv[4]), std::cout) == 0 ? 0 : 1;
+    }
+
     QCoreApplication a(argc, argv);
 
-    if (argc != 2){
-        throw std::runtime_error{"Add dimacs file as argument"};
+    /* Usage: dpll [--local-search | --config default|activity|decision] dimacs_file */
+    bool localSearch = argc == 3 && std::string{argv[1]} == "--local-search";
+    bool configured = argc == 4 && std::string{argv[1]} == "--config";
+    std::string config = configured ? argv[2] : "default";
+    if (argc != 2 && !localSearch && !configured){
+        throw std::runtime_error{"Usage: dpll [--local-search | --config default|activity|decision] dimacs_file"};
     }
 
-    std::ifstream dimacsStream(argv[1]);
+    std::ifstream dimacsStream(argv[argc - 1]);
     if (!dimacsStream.is_open()){
         throw std::runtime_error{"Bad path to dimacs file. (main)"};
     }
 
-    Solver s{dimacsStream};
-
-    OptionalPartialValuation solution = s.solve();
-    if (solution)
-    {
-        std::cout << "SAT" << std::endl;
-        std::cout << solution.value() << std::endl;
+    if (config == "default"){
+        solveAndPrint<Solver>(dimacsStream, localSearch);
     }
-    else
-    {
-        std::cout << "UNSAT" << std::endl;
+    else if (config == "activity"){
+        solveAndPrint<BasicSolver<ActivityPolicies>>(dimacsStream, localSearch);
+    }
+    else if (config == "decision"){
+        solveAndPrint<BasicSolver<DecisionSchemePolicies>>(dimacsStream, localSearch);
+    }
+    else {
+        throw std::runtime_error{"Unknown solver configuration. (main)"};
     }
 
 
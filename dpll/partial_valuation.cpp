@@ -84,6 +84,54 @@ bool PartialValuation::isClauseUnit(const Clause &c, Literal &lit) const {
     }
 }
 
+bool PartialValuation::isConstraintFalse(const CardinalityConstraint &c, Clause &explanation) const {
+
+    /* Constraint is false if more than bound of its literals are true. */
+
+    explanation.clear();
+    for (Literal lit : c.literals){
+        if (value(lit) == ExtendedBool::True){
+            explanation.push_back(-lit);
+            if (explanation.size() > c.bound){
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool PartialValuation::isConstraintUnit(const CardinalityConstraint &c, Literal &lit, Clause &explanation) const {
+
+    /* Counts true literals and remembers the first undefined one. */
+
+    unsigned countTrue = 0;
+    Literal undefinedLit = NullLiteral;
+    for (Literal l : c.literals){
+        ExtendedBool valueInPValuation = value(l);
+        if (valueInPValuation == ExtendedBool::True){
+            ++countTrue;
+        }
+        else if (valueInPValuation == ExtendedBool::Undefined && undefinedLit == NullLiteral){
+            undefinedLit = l;
+        }
+    }
+
+    if (countTrue != c.bound || undefinedLit == NullLiteral){
+        lit = NullLiteral;
+        return false;
+    }
+
+    lit = -undefinedLit;
+    explanation.clear();
+    explanation.push_back(lit);
+    for (Literal l : c.literals){
+        if (value(l) == ExtendedBool::True){
+            explanation.push_back(-l);
+        }
+    }
+    return true;
+}
+
 Literal PartialValuation::firstUndefined() const {
     auto it = std::find(_values.cbegin()+1, _values.cend(), ExtendedBool::Undefined);
     return it != _values.cend() ? it-_values.cbegin() : NullLiteral;
@@ -118,6 +166,32 @@ void PartialValuation::backjumpToLiteral(const Literal &lit, std::vector<Literal
     }
 }
 
+void PartialValuation::backtrackToLevel(unsigned level, std::vector<Literal> &literals) {
+
+    while (!_stack.empty() && _stack.back().second > level){
+        _values[std::abs(_stack.back().first)] = ExtendedBool::Undefined;
+        literals.push_back(_stack.back().first);
+        _stack.pop_back();
+    }
+    _currentLevel = level;
+}
+
+ExtendedBool PartialValuation::value(Literal lit) const {
+    ExtendedBool variableValue = _values[std::abs(lit)];
+    if (variableValue == ExtendedBool::Undefined || lit > 0){
+        return variableValue;
+    }
+    return variableValue == ExtendedBool::True ? ExtendedBool::False : ExtendedBool::True;
+}
+
+void PartialValuation::setValue(Literal lit) {
+    _values[std::abs(lit)] = lit > 0 ? ExtendedBool::True : ExtendedBool::False;
+}
+
+unsigned PartialValuation::nVars() const {
+    return _values.empty() ? 0 : _values.size() - 1;
+}
+
 void PartialValuation::lastAssertedLiteral(const Clause &c, Literal &lit, bool &empty) const {
     /*
         The last asserted literal of a clause c, is the literal from c that is on stack of partial valuation,
@@ -135,6 +209,21 @@ void PartialValuation::lastAssertedLiteral(const Clause &c, Literal &lit, bool &
     empty = true;
 }
 
+void PartialValuation::lastPropagatedLiteral(const Clause &c, Literal &lit, bool &empty) const {
+    /*
+        Literal is decided if it is the first literal on stack at its decision level (other than zero).
+    */
+    empty = false;
+    for (std::size_t i = _stack.size(); i-- > 0; ){
+        bool decided = _stack[i].second > 0 && (i == 0 || _stack[i-1].second < _stack[i].second);
+        if (!decided && std::find(c.cbegin(), c.cend(), _stack[i].first) != c.cend()){
+            lit = _stack[i].first;
+            return;
+        }
+    }
+    empty = true;
+}
+
 unsigned PartialValuation::numberOfTopLevelLiterals(const Clause &c) const {
     unsigned count = 0;
 
@@ -13,10 +13,26 @@ enum class ExtendedBool: int8_t {
     Undefined
 };
 
+/* Small instances can use 16-bit literals (DEFINES += DPLL_SMALL_LITERALS in dpll.pro), so that clauses take less memory */
+#ifdef DPLL_SMALL_LITERALS
+using Literal = int16_t;
+#else
 using Literal = int;
+#endif
 using Clause = std::vector<Literal>;
 using CNFFormula = std::vector<Clause>;
 
+/**
+ * @brief The CardinalityConstraint struct - constraint that at most bound of given literals are true.
+ * At-least constraints are kept as at-most constraints over negated literals.
+ */
+struct CardinalityConstraint {
+    std::vector<Literal> literals;
+    unsigned bound;
+};
+
+using CardinalityConstraints = std::vector<CardinalityConstraint>;
+
 class PartialValuation;
 
 std::ostream& operator<<(std::ostream &out, const PartialValuation &pval);
@@ -57,6 +73,27 @@ public:
     bool isClauseUnit(const Clause &c, Literal &lit) const;
 
 
+    /**
+     * @brief isConstraintFalse - Checks if cardinality constraint c is false in current partial valuation.
+     * Constraint is false if more than bound of its literals are true.
+     * @param explanation - clause that is set to negations of bound+1 true literals if constraint is false
+     * (that clause follows from constraint and is false in current partial valuation)
+     * @return - true if constraint is false, otherwise false
+     */
+    bool isConstraintFalse(const CardinalityConstraint &c, Clause &explanation) const;
+
+
+    /**
+     * @brief isConstraintUnit - Checks if cardinality constraint c propagates a literal.
+     * If exactly bound of its literals are true, every undefined literal of constraint must be false.
+     * @param lit - literal that is set to negation of the first undefined literal of constraint
+     * @param explanation - clause that is set to lit and negations of true literals
+     * (that clause follows from constraint and is unit in current partial valuation)
+     * @return - true if constraint propagates a literal, otherwise false
+     */
+    bool isConstraintUnit(const CardinalityConstraint &c, Literal &lit, Clause &explanation) const;
+
+
     /**
      * @brief firstUndefined - Returns first undefined literal in valuation (literal with smallest index).
      * It is used for decide rule - first undefined literal is chosen as decided literal.
@@ -83,6 +120,33 @@ public:
     void backjumpToLiteral(const Literal &lit, std::vector<Literal> &literals);
 
 
+    /**
+     * @brief backtrackToLevel - Deletes from stack all literals whose decision level is greater than given level.
+     * Those literals are added to vector literals.
+     */
+    void backtrackToLevel(unsigned level, std::vector<Literal> &literals);
+
+
+    /**
+     * @brief value - Returns value of literal lit in current partial valuation
+     * (ExtendedBool::True if lit is true, ExtendedBool::False if its negation is true).
+     */
+    ExtendedBool value(Literal lit) const;
+
+
+    /**
+     * @brief setValue - Sets variable of literal lit so that lit is true, without pushing it to stack.
+     * It is used only for extending final valuation to variables eliminated from formula.
+     */
+    void setValue(Literal lit);
+
+
+    /**
+     * @brief nVars - Returns number of variables.
+     */
+    unsigned nVars() const;
+
+
     /**
      * @brief lastAssertedLiteral - Sets literal lit to last asserted literal.
      * The last asserted literal of a clause c, is the literal from c that is on stack of partial valuation,
@@ -91,6 +155,13 @@ public:
     void lastAssertedLiteral(const Clause &c, Literal &lit, bool &empty) const;
 
 
+    /**
+     * @brief lastPropagatedLiteral - Sets literal lit to the last literal from c that is on stack of partial valuation
+     * and that was propagated (not decided). If there is no such literal, empty is set to true.
+     */
+    void lastPropagatedLiteral(const Clause &c, Literal &lit, bool &empty) const;
+
+
     /**
      * @brief numberOfTopLevelLiterals - Returns number of literals from partial vluation at current decision level
      * that are also present in clause c.
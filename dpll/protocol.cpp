@@ -0,0 +1,94 @@
+#include "protocol.h"
+
+#include <cerrno>
+#include <sys/socket.h>
+#include <unistd.h>
+
+static bool readAll(int fd, char *data, std::size_t length) {
+    while (length > 0){
+        ssize_t n = read(fd, data, length);
+        if (n < 0 && errno == EINTR){
+            continue;
+        }
+        if (n <= 0){
+            return false;
+        }
+        data += n;
+        length -= n;
+    }
+    return true;
+}
+
+static bool writeAll(int fd, const char *data, std::size_t length) {
+    while (length > 0){
+        /* MSG_NOSIGNAL - closed connection is reported as error instead of SIGPIPE */
+        ssize_t n = send(fd, data, length, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR){
+            continue;
+        }
+        if (n <= 0){
+            return false;
+        }
+        data += n;
+        length -= n;
+    }
+    return true;
+}
+
+static void appendUint32(std::string &out, uint32_t value) {
+    for (int shift = 24; shift >= 0; shift -= 8){
+        out.push_back(static_cast<char>((value >> shift) & 0xff));
+    }
+}
+
+bool readFrame(int fd, std::string &frame) {
+    unsigned char header[4];
+    if (!readAll(fd, reinterpret_cast<char*>(header), sizeof(header))){
+        return false;
+    }
+
+    uint32_t length = (uint32_t{header[0]} << 24) | (uint32_t{header[1]} << 16) | (uint32_t{header[2]} << 8) | header[3];
+    if (length > MaxFrameLength){
+        return false;
+    }
+
+    frame.resize(length);
+    return readAll(fd, &frame[0], length);
+}
+
+bool writeFrame(int fd, const std::string &frame) {
+    std::string header;
+    appendUint32(header, frame.size());
+    return writeAll(fd, header.data(), header.size()) && writeAll(fd, frame.data(), frame.size());
+}
+
+std::string encodeResponse(const std::optional<PartialValuation> &solution) {
+    std::string response;
+    if (!solution){
+        response.push_back(static_cast<char>(ResponseStatus::Unsat));
+        response.push_back(0);
+        return response;
+    }
+
+    const PartialValuation &valuation = solution.value();
+    unsigned nVars = valuation.nVars();
+
+    response.push_back(static_cast<char>(ResponseStatus::Sat));
+    response.push_back(0);
+    appendUint32(response, nVars);
+
+    std::string bitmap((nVars + 7) / 8, 0);
+    for (unsigned var = 1; var <= nVars; var++){
+        if (valuation.value(var) == ExtendedBool::True){
+            bitmap[(var - 1) / 8] |= 1 << ((var - 1) % 8);
+        }
+    }
+    return response + bitmap;
+}
+
+std::string encodeError(const std::string &message) {
+    std::string response;
+    response.push_back(static_cast<char>(ResponseStatus::Error));
+    response.push_back(0);
+    return response + message;
+}
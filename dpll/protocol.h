@@ -0,0 +1,54 @@
+#ifndef PROTOCOL_H
+#define PROTOCOL_H
+
+#include "partial_valuation.h"
+
+#include <cstdint>
+#include <optional>
+#include <string>
+
+/*
+    Framed binary protocol between solver server and its clients (over Unix domain socket).
+    Every message is a frame: 4-byte length (big-endian) followed by that many bytes.
+    Request frame contains formula in DIMACS format (as text).
+    Response frame contains status byte and flags byte, followed by:
+      - for SAT: 4-byte number of variables (big-endian) and bitmap of their values
+        (variable var is true if bit (var-1)%8 of byte (var-1)/8 is set),
+      - for UNSAT: nothing,
+      - for error: error message.
+*/
+
+enum class ResponseStatus: uint8_t {
+    Unsat = 0,
+    Sat = 1,
+    Error = 2
+};
+
+/* Flags of response */
+static constexpr uint8_t CachedResponse = 1; /* result was found in cache */
+
+static constexpr uint32_t MaxFrameLength = 1u << 28;
+
+/**
+ * @brief readFrame - Reads one frame from file descriptor fd.
+ * @return - false if connection is closed or frame is invalid, otherwise true
+ */
+bool readFrame(int fd, std::string &frame);
+
+/**
+ * @brief writeFrame - Writes frame to file descriptor fd.
+ * @return - false if connection is closed, otherwise true
+ */
+bool writeFrame(int fd, const std::string &frame);
+
+/**
+ * @brief encodeResponse - Encodes result of solving (valuation if formula is SAT, nothing if it is UNSAT) as response frame.
+ */
+std::string encodeResponse(const std::optional<PartialValuation> &solution);
+
+/**
+ * @brief encodeError - Encodes error message as response frame.
+ */
+std::string encodeError(const std::string &message);
+
+#endif // PROTOCOL_H
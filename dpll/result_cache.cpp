@@ -0,0 +1,69 @@
+#include "result_cache.h"
+
+#include <iterator>
+
+ResultCache::ResultCache(std::size_t capacity)
+    : _capacity(capacity)
+{}
+
+std::optional<std::string> ResultCache::find(const std::vector<int> &formula) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    auto it = findEntry(hash(formula), formula);
+    if (it == _index.end()){
+        return {};
+    }
+    _entries.splice(_entries.begin(), _entries, it->second);
+    return it->second->response;
+}
+
+void ResultCache::insert(const std::vector<int> &formula, const std::string &response) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (_capacity == 0){
+        return;
+    }
+
+    uint64_t formulaHash = hash(formula);
+    auto it = findEntry(formulaHash, formula);
+    if (it != _index.end()){
+        it->second->response = response;
+        _entries.splice(_entries.begin(), _entries, it->second);
+        return;
+    }
+
+    if (_entries.size() == _capacity){
+        auto range = _index.equal_range(_entries.back().hash);
+        for (auto old = range.first; old != range.second; old++){
+            if (old->second == std::prev(_entries.end())){
+                _index.erase(old);
+                break;
+            }
+        }
+        _entries.pop_back();
+    }
+    _entries.push_front({formulaHash, formula, response});
+    _index.emplace(formulaHash, _entries.begin());
+}
+
+uint64_t ResultCache::hash(const std::vector<int> &formula) {
+    uint64_t hash = 14695981039346656037ull;
+    for (int value : formula){
+        for (int i = 0; i < 4; i++){
+            hash ^= (static_cast<uint32_t>(value) >> (8 * i)) & 0xff;
+            hash *= 1099511628211ull;
+        }
+    }
+    return hash;
+}
+
+std::unordered_multimap<uint64_t, std::list<ResultCache::Entry>::iterator>::iterator
+ResultCache::findEntry(uint64_t hash, const std::vector<int> &formula) {
+    auto range = _index.equal_range(hash);
+    for (auto it = range.first; it != range.second; it++){
+        if (it->second->formula == formula){
+            return it;
+        }
+    }
+    return _index.end();
+}
@@ -0,0 +1,63 @@
+#ifndef RESULT_CACHE_H
+#define RESULT_CACHE_H
+
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief The ResultCache class - thread-safe LRU cache of encoded responses, keyed by canonical form of formula
+ * (see Solver::canonicalForm). Entries are found by hash of that form, and the whole form is compared,
+ * so formulas with the same hash never share a response. When cache is full, the least recently used response is removed.
+ */
+
+class ResultCache {
+
+public:
+    ResultCache(std::size_t capacity);
+
+    /**
+     * @brief find - Returns response for formula and marks it as most recently used, or nothing if it isn't cached.
+     */
+    std::optional<std::string> find(const std::vector<int> &formula);
+
+    /**
+     * @brief insert - Caches response for formula.
+     */
+    void insert(const std::vector<int> &formula, const std::string &response);
+
+private:
+
+    struct Entry {
+        uint64_t hash;
+        std::vector<int> formula;
+        std::string response;
+    };
+
+    /**
+     * @brief hash - FNV-1a hash of canonical form of formula
+     */
+    static uint64_t hash(const std::vector<int> &formula);
+
+    /**
+     * @brief findEntry - Returns index entry of formula with given hash, or _index.end()
+     */
+    std::unordered_multimap<uint64_t, std::list<Entry>::iterator>::iterator findEntry(uint64_t hash, const std::vector<int> &formula);
+
+    std::size_t _capacity;
+
+    /**
+     * @brief _entries - cached formulas and responses, from the most to the least recently used
+     */
+    std::list<Entry> _entries;
+
+    std::unordered_multimap<uint64_t, std::list<Entry>::iterator> _index;
+
+    std::mutex _mutex;
+};
+
+#endif // RESULT_CACHE_H
@@ -0,0 +1,170 @@
+#include "server.h"
+#include "protocol.h"
+#include "solver.h"
+
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+/* Largest number of variables in requested formula, memory for variables is allocated before formula is read */
+static constexpr unsigned MaxRequestVariables = 1 << 20;
+
+Server::Server(const std::string &socketPath, unsigned nWorkers, std::size_t cacheCapacity)
+    : _socketPath(socketPath), _cache(cacheCapacity), _nConnections(0), _stopped(false)
+{
+    sockaddr_un address{};
+    if (socketPath.size() >= sizeof(address.sun_path)){
+        throw std::runtime_error{"Socket path is too long. (server)"};
+    }
+    address.sun_family = AF_UNIX;
+    std::strcpy(address.sun_path, socketPath.c_str());
+
+    /* Socket left by previous server is replaced, but any other file at that path is kept */
+    struct stat status;
+    if (lstat(socketPath.c_str(), &status) == 0 && !S_ISSOCK(status.st_mode)){
+        throw std::runtime_error{"File " + socketPath + " exists and isn't a socket. (server)"};
+    }
+
+    _socket = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (_socket < 0){
+        throw std::runtime_error{std::string{"Can't create socket: "} + std::strerror(errno)};
+    }
+
+    unlink(socketPath.c_str());
+    if (bind(_socket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 || listen(_socket, SOMAXCONN) < 0){
+        std::string error = std::strerror(errno);
+        close(_socket);
+        throw std::runtime_error{"Can't listen on socket " + socketPath + ": " + error};
+    }
+
+    for (unsigned i = 0; i < nWorkers; i++){
+        _workers.emplace_back(&Server::work, this);
+    }
+}
+
+Server::~Server() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopped = true;
+        /* Readers that wait for requests or write responses fail and finish */
+        for (int connection : _connections){
+            shutdown(connection, SHUT_RDWR);
+        }
+    }
+    _requestQueued.notify_all();
+    for (std::thread &worker : _workers){
+        worker.join();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        while (!_requests.empty()){
+            _requests.front().response.set_value(encodeError("Server is stopped."));
+            _requests.pop();
+        }
+    }
+    for (auto &reader : _readers){
+        reader.second.join();
+    }
+
+    close(_socket);
+    unlink(_socketPath.c_str());
+}
+
+void Server::run() {
+    while (true){
+        int connection = accept(_socket, nullptr, nullptr);
+        if (connection < 0){
+            if (errno == EINTR || errno == ECONNABORTED){
+                continue;
+            }
+            throw std::runtime_error{std::string{"Can't accept connection: "} + std::strerror(errno)};
+        }
+
+        std::vector<std::thread> finished;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            for (unsigned id : _finishedReaders){
+                finished.push_back(std::move(_readers[id]));
+                _readers.erase(id);
+            }
+            _finishedReaders.clear();
+
+            _connections.insert(connection);
+            unsigned id = _nConnections++;
+            _readers.emplace(id, std::thread(&Server::serve, this, id, connection));
+        }
+        for (std::thread &reader : finished){
+            reader.join();
+        }
+    }
+}
+
+void Server::work() {
+    while (true){
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _requestQueued.wait(lock, [this]{ return _stopped || !_requests.empty(); });
+            if (_stopped){
+                return;
+            }
+            job = std::move(_requests.front());
+            _requests.pop();
+        }
+
+        job.response.set_value(respond(job.request));
+    }
+}
+
+void Server::serve(unsigned id, int connection) {
+    std::string request;
+    while (readFrame(connection, request)){
+        std::future<std::string> response;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (_stopped){
+                break;
+            }
+            _requests.push({std::move(request), {}});
+            response = _requests.back().response.get_future();
+        }
+        _requestQueued.notify_one();
+
+        if (!writeFrame(connection, response.get())){
+            break;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    _connections.erase(connection);
+    close(connection);
+    _finishedReaders.push_back(id);
+}
+
+std::string Server::respond(const std::string &request) {
+    try {
+        std::istringstream dimacsStream{request};
+        Solver s{dimacsStream, MaxRequestVariables};
+
+        std::vector<int> formula = s.canonicalForm();
+        std::optional<std::string> cached = _cache.find(formula);
+        if (cached){
+            std::string response = cached.value();
+            response[1] |= CachedResponse;
+            return response;
+        }
+
+        std::string response = encodeResponse(s.solve());
+        _cache.insert(formula, response);
+        return response;
+    }
+    catch (const std::exception &e) {
+        return encodeError(e.what());
+    }
+}
@@ -0,0 +1,84 @@
+#ifndef SERVER_H
+#define SERVER_H
+
+#include "result_cache.h"
+
+#include <condition_variable>
+#include <future>
+#include <map>
+#include <mutex>
+#include <queue>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief The Server class - long-running solver that accepts connections on Unix domain socket.
+ * Every connection has a reader thread that queues its requests, and requests are solved by a pool of worker threads,
+ * so busy connections don't keep workers from requests of other connections. On every connection, client sends formulas
+ * and receives results using framed protocol (see protocol.h). Results are cached by canonical form of formula,
+ * so repeated formulas are not solved again.
+ */
+
+class Server {
+
+public:
+    /**
+     * @brief Server - creates socket at given path (existing socket at that path is removed, other existing files are not) and starts worker threads
+     * @param nWorkers - number of worker threads, that is number of requests that are solved at the same time
+     * @param cacheCapacity - maximal number of cached results
+     */
+    Server(const std::string &socketPath, unsigned nWorkers, std::size_t cacheCapacity);
+
+    ~Server();
+
+    /**
+     * @brief run - Accepts connections and starts their readers. It never returns, unless accepting fails.
+     */
+    void run();
+
+private:
+
+    /**
+     * @brief Job - request that waits for worker, and promise of its response
+     */
+    struct Job {
+        std::string request;
+        std::promise<std::string> response;
+    };
+
+    /**
+     * @brief work - Responds to requests from queue, one by one.
+     */
+    void work();
+
+    /**
+     * @brief serve - Reader of connection: queues requests from connection and sends their responses, one request at a time,
+     * until client closes it. Then the connection is closed and the reader is marked as finished.
+     */
+    void serve(unsigned id, int connection);
+
+    /**
+     * @brief respond - Returns response for request containing formula in DIMACS format.
+     */
+    std::string respond(const std::string &request);
+
+
+    std::string _socketPath;
+    int _socket;
+    ResultCache _cache;
+
+    std::vector<std::thread> _workers;
+    std::map<unsigned, std::thread> _readers; /* reader threads by connection number */
+    std::vector<unsigned> _finishedReaders; /* readers that are not joined yet */
+    std::set<int> _connections; /* open connections */
+    unsigned _nConnections;
+
+    std::queue<Job> _requests; /* requests that wait for worker */
+    std::mutex _mutex;
+    std::condition_variable _requestQueued;
+    bool _stopped;
+};
+
+#endif // SERVER_H
@@ -1,17 +1,35 @@
 #include "solver.h"
+#include "local_search.h"
 
 #include <string>
 #include <sstream>
 #include <stdexcept>
 #include <iterator>
 #include <algorithm>
+#include <set>
+#include <limits>
 
-#define DEBUG
+/* Probing limits */
+static constexpr unsigned ProbeInterval = 100; /* number of conflicts between two probing rounds */
+static constexpr double ProbeTimeFraction = 0.1; /* share of search time that probing is allowed to use */
+static constexpr std::chrono::milliseconds MinProbeBudget{1}; /* time given to a round even if share is used up */
+static constexpr unsigned MaxHyperBinaryPerRound = 1000;
 
-Solver::Solver(std::istream &dimacsStream){
+/* Vivification limits */
+static constexpr unsigned MaxVivifyClausesPerRound = 50;
+static constexpr unsigned MaxVivifyPropagationsPerRound = 5000;
+
+/* Local search limits */
+static constexpr unsigned long LocalSearchFlips = 50000; /* flips per local search round */
+
+/* Clause count from header is only a hint, so memory reserved for clauses is limited */
+static constexpr std::size_t MaxReservedClauses = 1 << 20;
+
+template <typename Policies>
+BasicSolver<Policies>::BasicSolver(std::istream &dimacsStream, unsigned maxVariables){
 
     std::string line;
-    std::size_t firstNonSpaceIndex;
+    std::size_t firstNonSpaceIndex = std::string::npos;
 
     while (std::getline(dimacsStream, line)){
         firstNonSpaceIndex = line.find_first_not_of(" \t\r\n");
@@ -21,13 +39,13 @@ Solver::Solver(std::istream &dimacsStream){
     }
 
     /* Check if we read line of format 'p cnf varCount clauseCount' */
-    if (line[firstNonSpaceIndex] != 'p'){
+    if (firstNonSpaceIndex == std::string::npos || line[firstNonSpaceIndex] != 'p'){
         throw std::runtime_error{"Input file isn't in DIMACS format. (p)"};
     }
 
     std::istringstream parser{line.substr(firstNonSpaceIndex+1, std::string::npos)};
     std::string tmp;
-    if(!(parser >> tmp) || tmp != "cnf"){
+    if(!(parser >> tmp) || (tmp != "cnf" && tmp != "cnf+")){
         throw std::runtime_error{"Input file isn't in DIMACS format. (cnf)"};
     }
 
@@ -35,42 +53,105 @@ Solver::Solver(std::istream &dimacsStream){
     if (!(parser >> varCount >> clauseCount)){
         throw std::runtime_error{"Input file isn't in DIMACS format. (varCount, clauseCount)"};
     }
+    if (varCount > static_cast<unsigned>(std::numeric_limits<Literal>::max())){
+        throw std::runtime_error{"Number of variables is too large for literal type."};
+    }
+    if (varCount > maxVariables){
+        throw std::runtime_error{"Number of variables is too large. (at most " + std::to_string(maxVariables) + ")"};
+    }
 
-    /* Read clauses line by line, ignoring comments and empty lines. */
-    _formula.resize(clauseCount);
+    /* Read clauses and cardinality constraints line by line, ignoring comments and empty lines. */
+    _formula.reserve(std::min<std::size_t>(clauseCount, MaxReservedClauses));
     _valuation.reset(varCount);
-    int clauseIdx = 0;
     while(std::getline(dimacsStream, line)){
         firstNonSpaceIndex = line.find_first_not_of((" \t\r\n"));
         if (firstNonSpaceIndex != std::string::npos && line[firstNonSpaceIndex] != 'c'){
             parser.clear();
             parser.str(line);
-            std::copy(std::istream_iterator<int>{parser}, {}, std::back_inserter(_formula[clauseIdx]));
-            _formula[clauseIdx++].pop_back(); // pop zero from end of the line
+            std::vector<int> values;
+            std::copy(std::istream_iterator<int>{parser}, {}, std::back_inserter(values));
+
+            if (std::any_of(values.cbegin(), values.cend(), [varCount](int value){
+                    return static_cast<unsigned>(std::abs(value)) > varCount;})){
+                throw std::runtime_error{"Input file isn't in DIMACS format. (variable out of range)"};
+            }
+            Clause literals(values.cbegin(), values.cend());
+
+            if (parser.eof()){
+                if (literals.empty() || literals.back() != 0){
+                    throw std::runtime_error{"Input file isn't in DIMACS format. (clause must end with 0)"};
+                }
+                literals.pop_back(); // pop zero from end of the line
+                if (std::find(literals.cbegin(), literals.cend(), 0) != literals.cend()){
+                    throw std::runtime_error{"Input file isn't in DIMACS format. (0 inside clause)"};
+                }
+                _formula.push_back(literals);
+            }
+            else {
+                /* Literals are followed by relation and bound instead of zero */
+                parser.clear();
+                std::string relation;
+                int bound;
+                if (!(parser >> relation >> bound) || bound < 0
+                        || std::find(literals.cbegin(), literals.cend(), 0) != literals.cend()){
+                    throw std::runtime_error{"Input file isn't in DIMACS format. (cardinality constraint)"};
+                }
+                addCardinalityConstraint(literals, relation, bound);
+            }
         }
     }
 
     _nConflictTopLevelLiteras = -1;
+    _nOriginalClauses = _formula.size();
+    _substituted.resize(varCount + 1, false);
+    _phase.resize(varCount + 1, true);
 
 }
 
-Solver::Solver(const CNFFormula &formula)
-    : _formula(formula), _valuation(_formula.size()), _nConflictTopLevelLiteras(-1)
-{}
+template <typename Policies>
+BasicSolver<Policies>::BasicSolver(const CNFFormula &formula)
+    : _formula(formula), _nConflictTopLevelLiteras(-1)
+{
+    unsigned varCount = 0;
+    for (const Clause &c : _formula){
+        for (Literal lit : c){
+            varCount = std::max(varCount, static_cast<unsigned>(std::abs(lit)));
+        }
+    }
+    _valuation.reset(varCount);
+    _nOriginalClauses = _formula.size();
+    _substituted.resize(varCount + 1, false);
+    _phase.resize(varCount + 1, true);
+}
 
-OptionalPartialValuation Solver::solve(){
+template <typename Policies>
+OptionalPartialValuation BasicSolver<Policies>::solve(){
 
     Literal lit;
     Clause reason;
 
+    _nConflicts = 0;
+    _nextProbe = 0;
+    _nextProbeVariable = 1;
+    _searchStart = std::chrono::steady_clock::now();
+    _probeTime = std::chrono::steady_clock::duration::zero();
+    _nextVivify = _nOriginalClauses;
+    _nRestarts = 0;
+    _lastVivifyRestart = 0;
+    _nLocalSearches = 0;
+    _lastLocalSearchRestart = 0;
+    _decision.reset(_valuation.nVars());
+    _restart.reset();
+
     while (true){
 
         if (checkConflict()){
 
+            _nConflicts++;
             _nConflictTopLevelLiteras = _valuation.numberOfTopLevelLiterals(invertClause(_conflict));
 
             if (canBackjump()){
-                applyExplainUIP();
+                applyExplainBackjump();
                 applyLearn();
 
                 bool restart;
@@ -86,6 +167,13 @@ OptionalPartialValuation Solver::solve(){
 
                 _conflict.clear();
 
+                if (_restart.onConflict()){
+                    applyRestart();
+                }
+                if (_deletion.shouldReduce(_formula.size() - _nOriginalClauses)){
+                    reduceLearned();
+                }
+
             }
             else {
                 applyExplainEmpty();
@@ -102,19 +190,127 @@ OptionalPartialValuation Solver::solve(){
         }
 
         /* If there is no unit clause, we choose a literal that will be propagated */
-        else if ((lit = _valuation.firstUndefined())){
-            applyDecide(lit);
+        else if ((lit = _decision.pick(_valuation))){
+            /* At decision level zero, formula is periodically simplified before next decision */
+            if (_valuation.current_level() == 0){
+                if (inprocess()){
+                    continue;
+                }
+                /* Local search runs at the start and after restarts */
+                if (_nLocalSearches == 0 || _nRestarts > _lastLocalSearchRestart){
+                    OptionalPartialValuation found = localSearch();
+                    if (found){
+                        /* SAT */
+                        return found;
+                    }
+                }
+            }
+            applyDecide(_phase[lit] ? lit : -lit);
         }
 
         else {
             /* SAT */
-            return _valuation;
+            return extendModel(_valuation);
         }
     }
 }
 
 
-bool Solver::checkConflict() {
+template <typename Policies>
+void BasicSolver<Policies>::addCardinalityConstraint(const Clause &literals, const std::string &relation, unsigned bound){
+
+    std::vector<Literal> variables;
+    std::transform(literals.cbegin(), literals.cend(), std::back_inserter(variables), [](Literal lit){ return std::abs(lit); });
+    std::sort(variables.begin(), variables.end());
+    if (std::adjacent_find(variables.cbegin(), variables.cend()) != variables.cend()){
+        throw std::runtime_error{"Variable occurs more than once in cardinality constraint."};
+    }
+
+    if (relation == "<=" || relation == "="){
+        addAtMost(literals, bound);
+    }
+    if (relation == ">=" || relation == "="){
+        /* At least bound literals are true if at most (n - bound) of their negations are true */
+        if (bound > literals.size()){
+            _formula.push_back({});
+        }
+        else {
+            addAtMost(invertClause(literals), literals.size() - bound);
+        }
+    }
+    if (relation != "<=" && relation != ">=" && relation != "="){
+        throw std::runtime_error{"Input file isn't in DIMACS format. (cardinality relation)"};
+    }
+}
+
+template <typename Policies>
+void BasicSolver<Policies>::addAtMost(const Clause &literals, unsigned bound){
+    if (bound >= literals.size()){
+        return;
+    }
+
+    if (bound == 0){
+        for (Literal lit : literals){
+            _formula.push_back(Clause(1, -lit));
+        }
+    }
+    else if (bound + 1 == literals.size()){
+        /* At most n-1 literals are true if at least one of their negations is true */
+        _formula.push_back(invertClause(literals));
+    }
+    else {
+        _constraints.push_back({literals, bound});
+    }
+}
+
+template <typename Policies>
+bool BasicSolver<Policies>::satisfiesConstraints(const PartialValuation &valuation) const {
+    Clause explanation;
+    return std::none_of(_constraints.cbegin(), _constraints.cend(), [&valuation, &explanation](const CardinalityConstraint &c){
+        return valuation.isConstraintFalse(c, explanation);});
+}
+
+template <typename Policies>
+std::vector<int> BasicSolver<Policies>::canonicalForm() const {
+    CNFFormula clauses;
+    for (Clause c : _formula){
+        std::sort(c.begin(), c.end());
+        c.erase(std::unique(c.begin(), c.end()), c.end());
+        if (std::none_of(c.cbegin(), c.cend(), [&c](Literal lit){ return std::binary_search(c.cbegin(), c.cend(), -lit); })){
+            clauses.push_back(std::move(c));
+        }
+    }
+    std::sort(clauses.begin(), clauses.end());
+    clauses.erase(std::unique(clauses.begin(), clauses.end()), clauses.end());
+
+    /* Constraint is represented as its bound followed by its sorted literals */
+    CNFFormula constraints;
+    for (const CardinalityConstraint &constraint : _constraints){
+        Clause c = constraint.literals;
+        std::sort(c.begin(), c.end());
+        c.insert(c.begin(), constraint.bound);
+        constraints.push_back(std::move(c));
+    }
+    std::sort(constraints.begin(), constraints.end());
+    constraints.erase(std::unique(constraints.begin(), constraints.end()), constraints.end());
+
+    std::vector<int> form{static_cast<int>(_valuation.nVars())};
+    form.push_back(clauses.size());
+    for (const Clause &c : clauses){
+        form.push_back(c.size());
+        form.insert(form.end(), c.cbegin(), c.cend());
+    }
+    form.push_back(constraints.size());
+    for (const Clause &c : constraints){
+        form.push_back(c.front());
+        form.push_back(c.size() - 1);
+        form.insert(form.end(), c.cbegin() + 1, c.cend());
+    }
+    return form;
+}
+
+template <typename Policies>
+bool BasicSolver<Policies>::checkConflict() {
 
     for (Clause clauseInFormula : _formula) {
         if (_valuation.isClauseFalse(clauseInFormula)){
@@ -125,10 +321,22 @@ bool Solver::checkConflict() {
             return true;
         }
     }
+
+    Clause explanation;
+    for (const CardinalityConstraint &constraint : _constraints) {
+        if (_valuation.isConstraintFalse(constraint, explanation)){
+            _conflict = explanation;
+#ifdef DEBUG
+     std::cout << "Conflict clause (cardinality constraint): " << _conflict << std::endl;
+#endif
+            return true;
+        }
+    }
     return false;
 }
 
-bool Solver::checkUnit(Literal &lit, Clause &c){
+template <typename Policies>
+bool BasicSolver<Policies>::checkUnit(Literal &lit, Clause &c){
 
     for (Clause clauseInFormula : _formula){
         if(_valuation.isClauseUnit(clauseInFormula, lit)){
@@ -137,11 +345,18 @@ bool Solver::checkUnit(Literal &lit, Clause &c){
         }
     }
 
+    for (const CardinalityConstraint &constraint : _constraints){
+        if (_valuation.isConstraintUnit(constraint, lit, c)){
+            return true;
+        }
+    }
+
     return false;
 }
 
 
-void Solver::applyUnitPropagate(const Literal &lit, const Clause &c){
+template <typename Policies>
+void BasicSolver<Policies>::applyUnitPropagate(const Literal &lit, const Clause &c){
     _valuation.push(lit);
     _reason[std::abs(lit)] = c;
 #ifdef DEBUG
@@ -150,7 +365,8 @@ void Solver::applyUnitPropagate(const Literal &lit, const Clause &c){
 }
 
 
-void Solver::applyDecide(const Literal &lit){
+template <typename Policies>
+void BasicSolver<Policies>::applyDecide(const Literal &lit){
     _valuation.push(lit, true);
 #ifdef DEBUG
     std::cout << "Literal " << (lit < 0 ? "~p" : "p" )<< std::abs(lit) << " decided" << std::endl;
@@ -158,24 +374,17 @@ void Solver::applyDecide(const Literal &lit){
 }
 
 
-bool Solver::isUIP(){
-    /* first UIP - first unique implication point
-       Using the firstUIP strategy, the learning process is terminated when the backjump clause contains
-       exactly one literal from the current decision level.
-    */
-    return (_nConflictTopLevelLiteras == -1 || _nConflictTopLevelLiteras > 1) ? false : true;
-}
-
-void Solver::applyExplainUIP() {
-    while (!isUIP()){
+template <typename Policies>
+void BasicSolver<Policies>::applyExplainBackjump() {
+    while (!_analysis.isDone(invertClause(_conflict), _valuation, _nConflictTopLevelLiteras)){
         Literal lit;
-        bool empty;
-        _valuation.lastAssertedLiteral(invertClause(_conflict), lit, empty);
+        _analysis.nextLiteral(invertClause(_conflict), _valuation, lit);
         applyExplain(lit);
     }
 }
 
-void Solver::applyExplainEmpty() {
+template <typename Policies>
+void BasicSolver<Policies>::applyExplainEmpty() {
     while(!_conflict.empty()){
         Literal lit;
         bool empty;
@@ -184,27 +393,32 @@ void Solver::applyExplainEmpty() {
     }
 }
 
-void Solver::applyLearn(){
+template <typename Policies>
+void BasicSolver<Policies>::applyLearn(){
     _formula.push_back(_conflict);
+    _decision.onLearn(_conflict);
 #ifdef DEBUG
   std::cout << "Learned clause: " << _conflict << std::endl;
 #endif
 }
 
-void Solver::applyExplain(const Literal &lit){
+template <typename Policies>
+void BasicSolver<Policies>::applyExplain(const Literal &lit){
     Clause reason = _reason[std::abs(lit)];
     _conflict = resolve(_conflict, reason, lit);
     _nConflictTopLevelLiteras = _valuation.numberOfTopLevelLiterals(invertClause(_conflict));
 }
 
 
-Clause Solver::invertClause(const Clause &c){
+template <typename Policies>
+Clause BasicSolver<Policies>::invertClause(const Clause &c) const {
     Clause new_clause;
     std::for_each(c.cbegin(), c.cend(), [&new_clause](Literal lit){new_clause.push_back(-lit);});
     return new_clause;
 }
 
-Clause Solver::resolve(const Clause &c1, const Clause &c2, const Literal &lit) {
+template <typename Policies>
+Clause BasicSolver<Policies>::resolve(const Clause &c1, const Clause &c2, const Literal &lit) {
     Clause resolvent;
 
     /* Resolvent must contain all literals from first clause that are different from given literal (or its inverse). */
@@ -223,11 +437,13 @@ Clause Solver::resolve(const Clause &c1, const Clause &c2, const Literal &lit) {
 }
 
 
-bool Solver::canBackjump(){
+template <typename Policies>
+bool BasicSolver<Policies>::canBackjump(){
     return _valuation.current_level() > 0;
 }
 
-void Solver::applyBackjump(const Literal &lit) {
+template <typename Policies>
+void BasicSolver<Policies>::applyBackjump(const Literal &lit) {
     std::vector<Literal> literals;
     Literal literalForPropagation;
     bool empty;
@@ -241,13 +457,16 @@ void Solver::applyBackjump(const Literal &lit) {
     std::cout << "Backjumping to literal " << (lit < 0 ? "~p" : "p" )<< std::abs(lit) << std::endl;
 #endif
 
-    for (Literal l : literals)
+    for (Literal l : literals){
         _reason.erase(l);
+        _phase[std::abs(l)] = l > 0;
+    }
 
     applyUnitPropagate(-literalForPropagation, _conflict);
 }
 
-void Solver::getBackjumpLiteral(Literal &lit, bool &restart) {
+template <typename Policies>
+void BasicSolver<Policies>::getBackjumpLiteral(Literal &lit, bool &restart) {
     _valuation.lastAssertedLiteral(invertClause(_conflict), lit, restart);
 //#ifdef DEBUG
     //std::cout << "Last asserted before: " << lit << std::endl;
@@ -264,7 +483,8 @@ void Solver::getBackjumpLiteral(Literal &lit, bool &restart) {
 //#endif
 }
 
-void Solver::applyBackjumpToStart() {
+template <typename Policies>
+void BasicSolver<Policies>::applyBackjumpToStart() {
 #ifdef DEBUG
     std::cout << "Backjumping to start" << std::endl;
 #endif
@@ -276,6 +496,464 @@ void Solver::applyBackjumpToStart() {
     applyUnitPropagate(-literalForPropagation, _conflict);
 }
 
-void Solver::restart() {
+template <typename Policies>
+void BasicSolver<Policies>::restart() {
   _valuation.clear();
+  /* Substituted variables stay assigned at level zero (see substituteEquivalences) */
+  for (std::size_t var = 1; var < _substituted.size(); var++){
+    if (_substituted[var]){
+      _valuation.push(static_cast<Literal>(var));
+    }
+  }
+  _nRestarts++;
 }
+
+template <typename Policies>
+void BasicSolver<Policies>::applyRestart() {
+    if (_valuation.current_level() == 0){
+        return;
+    }
+#ifdef DEBUG
+    std::cout << "Restart" << std::endl;
+#endif
+    backtrackToLevel(0, true);
+    _nRestarts++;
+}
+
+template <typename Policies>
+void BasicSolver<Policies>::reduceLearned() {
+    std::size_t last = _formula.size() - 1;
+    removeClauses([this, last](std::size_t i, const Clause &c){
+        return i >= _nOriginalClauses && i != last && !_deletion.keep(c);});
+#ifdef DEBUG
+    std::cout << "Reduced learned clauses to " << _formula.size() - _nOriginalClauses << std::endl;
+#endif
+}
+
+template <typename Policies>
+template <typename Predicate>
+void BasicSolver<Policies>::removeClauses(Predicate remove) {
+    std::size_t kept = 0, keptOriginal = 0, keptBeforeVivify = 0;
+    for (std::size_t i = 0; i < _formula.size(); i++){
+        if (remove(i, _formula[i])){
+            continue;
+        }
+        if (i < _nOriginalClauses){
+            keptOriginal++;
+        }
+        if (i < _nextVivify){
+            keptBeforeVivify++;
+        }
+        if (kept != i){
+            _formula[kept] = std::move(_formula[i]);
+        }
+        kept++;
+    }
+    _formula.resize(kept);
+    _nOriginalClauses = keptOriginal;
+    _nextVivify = keptBeforeVivify;
+}
+
+template <typename Policies>
+bool BasicSolver<Policies>::propagate(std::vector<Literal> *implied) {
+    Literal lit;
+    Clause reason;
+
+    while (!checkConflict()){
+        if (!checkUnit(lit, reason)){
+            return true;
+        }
+        applyUnitPropagate(lit, reason);
+        if (implied){
+            implied->push_back(lit);
+        }
+    }
+    return false;
+}
+
+template <typename Policies>
+void BasicSolver<Policies>::backtrackToLevel(unsigned level, bool savePhases) {
+    std::vector<Literal> literals;
+    _valuation.backtrackToLevel(level, literals);
+    for (Literal l : literals){
+        _reason.erase(std::abs(l));
+        if (savePhases){
+            _phase[std::abs(l)] = l > 0;
+        }
+    }
+}
+
+template <typename Policies>
+bool BasicSolver<Policies>::shouldProbe() {
+    if (_nConflicts < _nextProbe){
+        return false;
+    }
+    _nextProbe = _nConflicts + ProbeInterval;
+
+    auto searchTime = std::chrono::steady_clock::now() - _searchStart;
+    return _probeTime <= searchTime * ProbeTimeFraction;
+}
+
+template <typename Policies>
+bool BasicSolver<Policies>::probe() {
+    auto start = std::chrono::steady_clock::now();
+    auto budget = std::chrono::duration_cast<std::chrono::steady_clock::duration>((start - _searchStart) * ProbeTimeFraction) - _probeTime;
+    auto deadline = start + std::max<std::chrono::steady_clock::duration>(budget, MinProbeBudget);
+
+    /* Binary clauses that already exist, so that the same hyper-binary resolvent is not learned twice */
+    std::set<std::pair<Literal, Literal>> binaries;
+    for (const Clause &c : _formula){
+        if (c.size() == 2){
+            binaries.insert(std::minmax(c[0], c[1]));
+        }
+    }
+
+    bool changed = false;
+    unsigned nHyperBinary = 0;
+    unsigned nVars = _valuation.nVars();
+
+    for (unsigned i = 0; i < nVars && std::chrono::steady_clock::now() < deadline; i++){
+        Literal var = _nextProbeVariable;
+        _nextProbeVariable = var % nVars + 1;
+
+        if (_substituted[var]){
+            continue;
+        }
+
+        for (Literal lit : {var, static_cast<Literal>(-var)}){
+            if (_valuation.value(lit) != ExtendedBool::Undefined){
+                break;
+            }
+#ifdef DEBUG
+            std::cout << "Probing literal " << (lit < 0 ? "~p" : "p" ) << std::abs(lit) << std::endl;
+#endif
+            std::vector<Literal> implied;
+            _valuation.push(lit, true);
+            bool failed = !propagate(&implied);
+
+            /* Every literal implied by non-binary clause gives hyper-binary resolvent (~lit \/ implied) */
+            CNFFormula resolvents;
+            for (Literal l : implied){
+                if (_reason[std::abs(l)].size() > 2 && nHyperBinary < MaxHyperBinaryPerRound
+                        && binaries.insert(std::minmax<Literal>(-lit, l)).second){
+                    resolvents.push_back(Clause{static_cast<Literal>(-lit), l});
+                    nHyperBinary++;
+                }
+            }
+
+            _conflict.clear();
+            backtrackToLevel(0);
+
+            if (failed){
+#ifdef DEBUG
+                std::cout << "Failed literal " << (lit < 0 ? "~p" : "p" ) << std::abs(lit) << std::endl;
+#endif
+                _formula.push_back(Clause(1, -lit));
+                changed = true;
+                /* Negation of failed literal is propagated at level zero before probing continues */
+                if (!propagate()){
+                    _conflict.clear();
+                    _probeTime += std::chrono::steady_clock::now() - start;
+                    return true;
+                }
+                break;
+            }
+
+            for (Clause &c : resolvents){
+#ifdef DEBUG
+                std::cout << "Learned hyper-binary resolvent: " << c << std::endl;
+#endif
+                _formula.push_back(std::move(c));
+                changed = true;
+            }
+        }
+    }
+
+    if (substituteEquivalences()){
+        changed = true;
+    }
+
+    _probeTime += std::chrono::steady_clock::now() - start;
+    return changed;
+}
+
+template <typename Policies>
+bool BasicSolver<Policies>::substituteEquivalences() {
+    /* Literal lit is represented as node 2*|lit| (positive) or 2*|lit|+1 (negative) of implication graph */
+    auto node = [](Literal lit){ return 2 * std::abs(lit) + (lit < 0 ? 1 : 0); };
+    auto literal = [](int n){ return n % 2 ? -(n / 2) : n / 2; };
+
+    int nNodes = 2 * (_valuation.nVars() + 1);
+    std::vector<std::vector<int>> edges(nNodes);
+    for (const Clause &c : _formula){
+        if (c.size() == 2 && _valuation.value(c[0]) == ExtendedBool::Undefined
+                && _valuation.value(c[1]) == ExtendedBool::Undefined){
+            /* (a \/ b) gives implications ~a -> b and ~b -> a */
+            edges[node(-c[0])].push_back(node(c[1]));
+            edges[node(-c[1])].push_back(node(c[0]));
+        }
+    }
+
+    /* Tarjan's algorithm for strongly connected components. Depth first search uses explicit stack of
+       (node, index of next edge), because implication chains can be as long as the number of variables. */
+    std::vector<int> index(nNodes, -1), lowLink(nNodes, 0), stack;
+    std::vector<bool> onStack(nNodes, false);
+    std::vector<std::vector<Literal>> components;
+    std::vector<std::pair<int, std::size_t>> search;
+    int nextIndex = 0;
+
+    for (int root = 2; root < nNodes; root++){
+        if (index[root] != -1 || edges[root].empty()){
+            continue;
+        }
+
+        search.emplace_back(root, 0);
+        while (!search.empty()){
+            int v = search.back().first;
+            std::size_t &nextEdge = search.back().second;
+
+            if (nextEdge == 0 && index[v] == -1){
+                index[v] = lowLink[v] = nextIndex++;
+                stack.push_back(v);
+                onStack[v] = true;
+            }
+
+            if (nextEdge < edges[v].size()){
+                int w = edges[v][nextEdge++];
+                if (index[w] == -1){
+                    search.emplace_back(w, 0);
+                }
+                else if (onStack[w]){
+                    lowLink[v] = std::min(lowLink[v], index[w]);
+                }
+                continue;
+            }
+
+            /* All edges of v are visited */
+            search.pop_back();
+            if (!search.empty()){
+                int parent = search.back().first;
+                lowLink[parent] = std::min(lowLink[parent], lowLink[v]);
+            }
+
+            if (lowLink[v] == index[v]){
+                std::vector<Literal> component;
+                int w;
+                do {
+                    w = stack.back();
+                    stack.pop_back();
+                    onStack[w] = false;
+                    component.push_back(literal(w));
+                } while (w != v);
+                if (component.size() > 1){
+                    components.push_back(component);
+                }
+            }
+        }
+    }
+
+    /* Variables of cardinality constraints are not substituted */
+    std::vector<bool> inConstraint(_valuation.nVars() + 1, false);
+    for (const CardinalityConstraint &constraint : _constraints){
+        for (Literal lit : constraint.literals){
+            inConstraint[std::abs(lit)] = true;
+        }
+    }
+
+    /* replacement[var] is literal that replaces variable var, or NullLiteral */
+    std::vector<Literal> replacement(_valuation.nVars() + 1, NullLiteral);
+    bool found = false;
+    for (const std::vector<Literal> &component : components){
+        Literal representative = *std::min_element(component.cbegin(), component.cend(), [](Literal a, Literal b){
+            return std::abs(a) < std::abs(b);});
+
+        if (std::any_of(component.cbegin(), component.cend(), [representative](Literal l){ return l == -representative; })){
+#ifdef DEBUG
+            std::cout << "Literal " << (representative < 0 ? "~p" : "p" ) << std::abs(representative)
+                      << " is equivalent to its negation" << std::endl;
+#endif
+            _formula.push_back(Clause(1, representative));
+            _formula.push_back(Clause(1, -representative));
+            return true;
+        }
+
+        /* Every component has its mirror component of negated literals, only one of them is used */
+        if (representative < 0){
+            continue;
+        }
+        for (Literal l : component){
+            if (l != representative && !inConstraint[std::abs(l)]){
+                replacement[std::abs(l)] = l > 0 ? representative : -representative;
+                _substituted[std::abs(l)] = true;
+                _substitutions.emplace_back(std::abs(l), replacement[std::abs(l)]);
+                found = true;
+#ifdef DEBUG
+                std::cout << "Variable p" << std::abs(l) << " substituted with equivalent literal "
+                          << (replacement[std::abs(l)] < 0 ? "~p" : "p" ) << representative << std::endl;
+#endif
+            }
+        }
+    }
+
+    if (!found){
+        return false;
+    }
+
+    for (Clause &c : _formula){
+        for (Literal &lit : c){
+            Literal r = replacement[std::abs(lit)];
+            if (r != NullLiteral){
+                lit = lit > 0 ? r : -r;
+            }
+        }
+        std::sort(c.begin(), c.end());
+        c.erase(std::unique(c.begin(), c.end()), c.end());
+    }
+
+    /* Clauses that contain both literal and its negation are tautologies and are removed */
+    removeClauses([](std::size_t, const Clause &c){
+        return std::any_of(c.cbegin(), c.cend(), [&c](Literal lit){ return std::binary_search(c.cbegin(), c.cend(), -lit); });});
+
+    /* Substituted variables no longer occur in formula, so they are assigned at level zero instead of being decided.
+       Their real value is set by extendModel. */
+    for (std::size_t var = 1; var < replacement.size(); var++){
+        if (replacement[var] != NullLiteral){
+            _valuation.push(static_cast<Literal>(var));
+        }
+    }
+
+    return true;
+}
+
+template <typename Policies>
+bool BasicSolver<Policies>::vivify() {
+    _lastVivifyRestart = _nRestarts;
+
+    /* Candidates are the shortest learned clauses since the last round, processed from the end of formula
+       so that removing a clause does not move the ones that are still to be processed */
+    std::vector<std::size_t> candidates;
+    for (std::size_t i = std::max(_nextVivify, _nOriginalClauses); i < _formula.size(); i++){
+        if (_formula[i].size() > 1){
+            candidates.push_back(i);
+        }
+    }
+
+    if (candidates.size() > MaxVivifyClausesPerRound){
+        std::nth_element(candidates.begin(), candidates.begin() + MaxVivifyClausesPerRound, candidates.end(),
+                         [this](std::size_t a, std::size_t b){ return _formula[a].size() < _formula[b].size(); });
+        candidates.resize(MaxVivifyClausesPerRound);
+    }
+    std::sort(candidates.rbegin(), candidates.rend());
+
+    bool changed = false;
+    unsigned nPropagations = 0;
+
+    for (std::size_t idx : candidates){
+        if (nPropagations > MaxVivifyPropagationsPerRound){
+            break;
+        }
+
+        Clause c = std::move(_formula[idx]);
+        _formula.erase(_formula.begin() + idx);
+
+        Clause vivified;
+        bool satisfied = false;
+        for (Literal lit : c){
+            ExtendedBool value = _valuation.value(lit);
+            if (value == ExtendedBool::True){
+                /* Clause is true at level zero, or lit is implied by negations of previous literals */
+                satisfied = _valuation.current_level() == 0;
+                vivified.push_back(lit);
+                break;
+            }
+            if (value == ExtendedBool::False){
+                /* lit is false at level zero, or implied false by negations of previous literals */
+                continue;
+            }
+
+            vivified.push_back(lit);
+            std::vector<Literal> implied;
+            _valuation.push(-lit, true);
+            bool conflict = !propagate(&implied);
+            nPropagations += implied.size();
+            if (conflict){
+                break;
+            }
+        }
+
+        _conflict.clear();
+        backtrackToLevel(0);
+
+        if (satisfied){
+#ifdef DEBUG
+            std::cout << "Deleted satisfied clause: " << c << std::endl;
+#endif
+            changed = true;
+            continue;
+        }
+
+        if (vivified.size() < c.size()){
+#ifdef DEBUG
+            std::cout << "Vivified clause " << c << " into clause " << vivified << std::endl;
+#endif
+            c = std::move(vivified);
+            changed = true;
+        }
+        _formula.insert(_formula.begin() + idx, std::move(c));
+    }
+    /* Set after deletions, so that clauses learned from now on are candidates in the next round */
+    _nextVivify = _formula.size();
+
+    return changed;
+}
+
+template <typename Policies>
+bool BasicSolver<Policies>::inprocess() {
+    if (shouldProbe() && probe()){
+        return true;
+    }
+    if (_nRestarts > _lastVivifyRestart){
+        return vivify();
+    }
+    return false;
+}
+
+template <typename Policies>
+OptionalPartialValuation BasicSolver<Policies>::solveLocalSearch(unsigned long maxFlips, unsigned seed) {
+    LocalSearch search(_formula, _valuation.nVars(), seed);
+    OptionalPartialValuation found = search.run(maxFlips);
+    if (found && satisfiesConstraints(found.value())){
+        return extendModel(found.value());
+    }
+    return {};
+}
+
+template <typename Policies>
+OptionalPartialValuation BasicSolver<Policies>::localSearch() {
+    _lastLocalSearchRestart = _nRestarts;
+
+    LocalSearch search(_formula, _valuation.nVars(), _nLocalSearches++);
+    OptionalPartialValuation found = search.run(LocalSearchFlips, _phase);
+    if (found && satisfiesConstraints(found.value())){
+#ifdef DEBUG
+        std::cout << "Local search found satisfying valuation" << std::endl;
+#endif
+        return extendModel(found.value());
+    }
+
+    _phase = search.bestValuation();
+    return {};
+}
+
+template <typename Policies>
+PartialValuation BasicSolver<Policies>::extendModel(const PartialValuation &valuation) const {
+    PartialValuation model = valuation;
+    for (auto it = _substitutions.crbegin(); it != _substitutions.crend(); it++){
+        model.setValue(model.value(it->second) == ExtendedBool::True ? it->first : -it->first);
+    }
+    return model;
+}
+
+template class BasicSolver<DefaultPolicies>;
+template class BasicSolver<ActivityPolicies>;
+template class BasicSolver<DecisionSchemePolicies>;
@@ -2,26 +2,41 @@
 #define SOLVER_H
 
 #include "partial_valuation.h"
+#include "solver_policies.h"
 
 #include <iostream>
 #include <optional>
 #include <map>
+#include <chrono>
+#include <string>
+#include <limits>
 
 using OptionalPartialValuation = std::optional<PartialValuation>;
 
-class Solver {
+/**
+ * @brief The BasicSolver class - DPLL solver with clause learning and backjumping.
+ * Strategies of search are given by Policies (see solver_policies.h): Policies::Decision, Policies::Restart,
+ * Policies::Deletion and Policies::Analysis. Configurations are instantiated in solver.cpp.
+ */
+
+template <typename Policies>
+class BasicSolver {
 public:
     /**
-     * @brief Solver - constructor from data that are given in DIMACS format
+     * @brief BasicSolver - constructor from data that are given in DIMACS format.
+     * Besides clauses, lines can contain cardinality constraints in format 'l1 l2 ... ln <= k'
+     * (also '>= k' and '= k'), and header can be 'p cnf+ varCount clauseCount'.
+     * Every line holds one clause, so 0 can only be its last number.
      * @param dimacsStream - input stream
+     * @param maxVariables - largest accepted varCount, memory for variables is allocated before clauses are read
      */
-    Solver(std::istream &dimacsStream);
+    BasicSolver(std::istream &dimacsStream, unsigned maxVariables = std::numeric_limits<Literal>::max());
 
     /**
-     * @brief Solver - constructor from CNF formula
+     * @brief BasicSolver - constructor from CNF formula
      * @param formula - CNF formula for which satisfiability is checked
      */
-    Solver(const CNFFormula &formula);
+    BasicSolver(const CNFFormula &formula);
 
 
     /**
@@ -30,17 +45,55 @@ public:
      */
     OptionalPartialValuation solve();
 
+    /**
+     * @brief solveLocalSearch - Stochastic local search (see LocalSearch) instead of DPLL procedure
+     * @param maxFlips - maximal number of flips
+     * @param seed - seed of random number generator
+     * Cardinality constraints are not part of local search, so found valuation is returned only if it satisfies them.
+     * @return - partial valuaton if satisfying valuation is found, otherwise nothing (problem can still be SAT)
+     */
+    OptionalPartialValuation solveLocalSearch(unsigned long maxFlips, unsigned seed = 0);
+
+    /**
+     * @brief canonicalForm - Returns canonical form of formula: literals in clauses are sorted, clauses are sorted,
+     * and repeated literals and clauses, and tautologies, are removed. Formulas that differ only in that have the same form.
+     * Form is written as numbers: number of variables, number of clauses, every clause as its size followed by its literals,
+     * number of constraints and every constraint as its bound, size and literals.
+     * It must be called before solving, because learned clauses are added to formula.
+     */
+    std::vector<int> canonicalForm() const;
+
 private:
 
     /**
-     * @brief checkConflict - checks if conflict clause exists
-     * @return - true if there is a clause in which conflict occured, otherwise false
+     * @brief addCardinalityConstraint - Adds constraint that relation ('<=', '>=' or '=') holds between number
+     * of true literals and bound. Constraints that are trivially true are skipped, and those that are equivalent
+     * to clauses are added as clauses.
+     */
+    void addCardinalityConstraint(const Clause &literals, const std::string &relation, unsigned bound);
+
+    /**
+     * @brief addAtMost - Adds constraint that at most bound of literals are true.
+     */
+    void addAtMost(const Clause &literals, unsigned bound);
+
+    /**
+     * @brief satisfiesConstraints - Checks if total valuation satisfies all cardinality constraints.
+     */
+    bool satisfiesConstraints(const PartialValuation &valuation) const;
+
+    /**
+     * @brief checkConflict - checks if conflict clause exists.
+     * Cardinality constraints are scanned like clauses, counting their true literals on every call, and constraint
+     * in which conflict occured gives conflict clause that explains it. That clause is built right away (not lazily).
+     * @return - true if there is a clause or constraint in which conflict occured, otherwise false
      */
     bool checkConflict();
 
     /**
-     * @brief checkUnit - checks if unit clause exists
-     * @param c - clause that is set to unit clause if it exists
+     * @brief checkUnit - checks if unit clause exists, or cardinality constraint that propagates a literal
+     * @param c - clause that is set to unit clause if it exists (or to clause that explains propagation by constraint,
+     * which is built right away and stored as reason of propagated literal, like a unit clause)
      * @param lit - literal that is set to undefined literal of unit clause
      * @return - true if unit clause exists, otherwise false
      */
@@ -62,18 +115,11 @@ private:
 
 
     /**
-     * @brief isUIP - Checks if learning process should be terminated based on firstUIP (first unique implication point) strategy.
-     * The learning process is terminated when the backjump clause contains exactly one literal from the current decision level.
-     * @return - true if learning process should be terminated, otherwise false
+     * @brief applyExplainBackjump - Constructs backjump clause if conflict occured at a decision level other then zero.
+     * It resolves out literals of inverted conflict clause chosen by analysis policy using the applyExplain function
+     * until conflict clause satisfies the condition of analysis policy (for example, firstUIP condition).
      */
-    bool isUIP();
-
-    /**
-     * @brief applyExplainUIP - Constructs backjump clause if conflict occured at a decision level other then zero.
-     * It resolves out the last asserted literal of inverted conflict clause using the applyExplain function until conflict clause
-     * satisfies the firstUIP condition.
-     */
-    void applyExplainUIP();
+    void applyExplainBackjump();
 
     /**
      * @brief applyExplainEmpty - Constructs backjump clause if conflict occured at a decision level zero.
@@ -98,7 +144,7 @@ private:
      * @brief invertClause - inverts literals of clause c
      * @return - inverted clause
      */
-    Clause invertClause(const Clause &c);
+    Clause invertClause(const Clause &c) const;
 
     /**
      * @brief resolve - Resolves out literal lit using clauses c1 and c2
@@ -128,13 +174,123 @@ private:
 
     void restart();
 
+    /**
+     * @brief applyRestart - Backtracks to decision level zero when restart policy requires it. Literals assigned at level zero are kept.
+     */
+    void applyRestart();
+
+    /**
+     * @brief reduceLearned - Deletes learned clauses that deletion policy doesn't keep.
+     */
+    void reduceLearned();
+
+    /**
+     * @brief removeClauses - Removes clauses of formula for which remove(index, clause) is true, keeping indices of learned clauses
+     * and of vivification candidates up to date.
+     */
+    template <typename Predicate>
+    void removeClauses(Predicate remove);
+
+
+    /**
+     * @brief propagate - Exhaustively applies unit propagation on current decision level.
+     * @param implied - if not null, propagated literals are added to it
+     * @return - false if conflict occured, otherwise true
+     */
+    bool propagate(std::vector<Literal> *implied = nullptr);
+
+    /**
+     * @brief backtrackToLevel - Backtracks to given decision level and forgets reasons of unassigned literals.
+     * @param savePhases - if true, polarities of unassigned literals are saved as their phases
+     */
+    void backtrackToLevel(unsigned level, bool savePhases = false);
+
+    /**
+     * @brief shouldProbe - Checks if enough conflicts occured since the last probing round and
+     * if time spent in probing is still within its share of search time.
+     */
+    bool shouldProbe();
+
+    /**
+     * @brief probe - Inprocessing at decision level zero. Every undefined literal is decided and propagated.
+     * If it leads to conflict, its negation is learned as unit clause (failed literal).
+     * Every literal propagated by a non-binary clause is learned as binary clause with negation of probed literal
+     * (hyper-binary resolvent). Afterwards, equivalent literals are substituted (see substituteEquivalences).
+     * @return - true if formula was changed, otherwise false
+     */
+    bool probe();
+
+    /**
+     * @brief substituteEquivalences - Finds strongly connected components of binary implication graph.
+     * Literals of the same component are equivalent, so every variable of component is replaced in formula
+     * by the literal with smallest variable. If component contains both literal and its negation, formula is UNSAT
+     * and both are learned as unit clauses.
+     * @return - true if formula was changed, otherwise false
+     */
+    bool substituteEquivalences();
+
+    /**
+     * @brief vivify - Inprocessing at decision level zero. The shortest clauses learned since the last vivification round
+     * are strengthened: negations of their literals are decided one at a time and propagated (without the clause itself).
+     * Literals that become false are redundant and are removed. If a literal becomes true, or conflict occurs,
+     * the remaining literals are removed. Clauses satisfied at level zero are deleted.
+     * @return - true if formula was changed, otherwise false
+     */
+    bool vivify();
+
+    /**
+     * @brief inprocess - Simplifies formula at decision level zero by probing and vivification, when they are due.
+     * @return - true if formula was changed, otherwise false
+     */
+    bool inprocess();
+
+    /**
+     * @brief localSearch - Local search at decision level zero, starting from saved phases, on formula with learned clauses.
+     * Cardinality constraints are not part of local search, so found valuation is used only if it satisfies them.
+     * Best valuation that is found is saved as phases of variables, so that following decisions continue from it.
+     * @return - partial valuaton if satisfying valuation is found, otherwise nothing
+     */
+    OptionalPartialValuation localSearch();
+
+    /**
+     * @brief extendModel - Returns valuation extended to variables that were substituted by equivalent literals.
+     */
+    PartialValuation extendModel(const PartialValuation &valuation) const;
+
+
+    typename Policies::Decision _decision;
+    typename Policies::Restart _restart;
+    typename Policies::Deletion _deletion;
+    typename Policies::Analysis _analysis;
 
     CNFFormula _formula;
+    CardinalityConstraints _constraints;
     PartialValuation _valuation;
     Clause _conflict;
     std::map<Literal, Clause> _reason; /* maps the literal and clause that is a reason for its poropagation */
     int _nConflictTopLevelLiteras; /* number of literals from conflict clause on last decision level */
 
+    std::size_t _nOriginalClauses; /* clauses of formula from that index on are learned */
+    std::size_t _nextVivify; /* learned clauses from that index on are candidates for vivification */
+    unsigned _nRestarts;
+    unsigned _lastVivifyRestart; /* number of restarts when vivification was last done */
+    unsigned _nLocalSearches;
+    unsigned _lastLocalSearchRestart; /* number of restarts when local search was last done */
+    std::vector<bool> _phase; /* saved polarity of variables, used when they are decided */
+    unsigned _nConflicts; /* number of conflicts since the start of search */
+    unsigned _nextProbe; /* number of conflicts after which next probing round is allowed */
+    Literal _nextProbeVariable; /* variable from which next probing round continues */
+    std::chrono::steady_clock::time_point _searchStart;
+    std::chrono::steady_clock::duration _probeTime; /* total time spent in probing */
+    std::vector<bool> _substituted; /* marks variables that are substituted by equivalent literal */
+    std::vector<std::pair<Literal, Literal>> _substitutions; /* variable and literal equivalent to it, in order of substitution */
+
 };
 
+extern template class BasicSolver<DefaultPolicies>;
+extern template class BasicSolver<ActivityPolicies>;
+extern template class BasicSolver<DecisionSchemePolicies>;
+
+using Solver = BasicSolver<DefaultPolicies>;
+
 #endif // SOLVER_H
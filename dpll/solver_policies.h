@@ -0,0 +1,256 @@
+#ifndef SOLVER_POLICIES_H
+#define SOLVER_POLICIES_H
+
+#include "partial_valuation.h"
+
+#include <vector>
+
+/*
+    Policies of BasicSolver (see solver.h). Each kind of policy has its interface, and BasicSolver calls it directly,
+    so that every configuration is compiled on its own, without virtual calls.
+
+    Decision policy:
+        void reset(unsigned nVars)                   - called before search
+        void onLearn(const Clause &learned)          - called for every clause learned from conflict
+        Literal pick(const PartialValuation &v)      - returns undefined variable that is decided next, or NullLiteral
+
+    Restart policy:
+        void reset()
+        bool onConflict()                            - called after every backjump, returns true if search should restart
+
+    Deletion policy:
+        bool shouldReduce(std::size_t nLearned)      - called after every backjump, returns true if learned clauses should be reduced
+        bool keep(const Clause &learned)             - returns true if learned clause is kept when they are reduced
+
+    Analysis policy:
+        bool isDone(const Clause &invertedConflict, const PartialValuation &v, int nTopLevelLiterals)
+                                                     - returns true if conflict clause can be used as backjump clause
+        void nextLiteral(const Clause &invertedConflict, const PartialValuation &v, Literal &lit)
+                                                     - sets lit to literal that is resolved out next
+*/
+
+
+/**
+ * @brief The LexicographicDecision class - decides the first undefined variable (variable with smallest index).
+ */
+class LexicographicDecision {
+public:
+    void reset(unsigned) {}
+
+    void onLearn(const Clause &) {}
+
+    Literal pick(const PartialValuation &valuation) const {
+        return valuation.firstUndefined();
+    }
+};
+
+
+/**
+ * @brief The ActivityDecision class - decides undefined variable with the largest activity.
+ * Activity of variable is increased every time it occurs in learned clause, and the increase grows with every learned clause,
+ * so recent conflicts matter more (VSIDS).
+ */
+class ActivityDecision {
+public:
+    void reset(unsigned nVars) {
+        _activity.assign(nVars + 1, 0.0);
+        _increment = 1.0;
+    }
+
+    void onLearn(const Clause &learned) {
+        for (Literal lit : learned){
+            _activity[std::abs(lit)] += _increment;
+            if (_activity[std::abs(lit)] > 1e100){
+                for (double &a : _activity){
+                    a *= 1e-100;
+                }
+                _increment *= 1e-100;
+            }
+        }
+        _increment /= Decay;
+    }
+
+    Literal pick(const PartialValuation &valuation) const {
+        Literal best = NullLiteral;
+        for (std::size_t var = 1; var < _activity.size(); var++){
+            if (valuation.value(static_cast<Literal>(var)) == ExtendedBool::Undefined
+                    && (best == NullLiteral || _activity[var] > _activity[best])){
+                best = static_cast<Literal>(var);
+            }
+        }
+        return best;
+    }
+
+private:
+    static constexpr double Decay = 0.95;
+
+    std::vector<double> _activity;
+    double _increment;
+};
+
+
+/**
+ * @brief The NoRestarts class - search is restarted only when it backjumps to start.
+ */
+class NoRestarts {
+public:
+    void reset() {}
+
+    bool onConflict() {
+        return false;
+    }
+};
+
+
+/**
+ * @brief The LubyRestarts class - search is restarted after numbers of conflicts that follow Luby sequence (1, 1, 2, 1, 1, 2, 4, ...),
+ * multiplied by Unit.
+ */
+class LubyRestarts {
+public:
+    void reset() {
+        _nRestarts = 0;
+        _nConflicts = 0;
+    }
+
+    bool onConflict() {
+        if (++_nConflicts < Unit * luby(_nRestarts + 1)){
+            return false;
+        }
+        _nRestarts++;
+        _nConflicts = 0;
+        return true;
+    }
+
+private:
+    static constexpr unsigned Unit = 100;
+
+    static unsigned luby(unsigned i) {
+        while (true){
+            unsigned k = 1;
+            while ((1u << k) - 1 < i){
+                k++;
+            }
+            if ((1u << k) - 1 == i){
+                return 1u << (k - 1);
+            }
+            i -= (1u << (k - 1)) - 1;
+        }
+    }
+
+    unsigned _nRestarts;
+    unsigned _nConflicts;
+};
+
+
+/**
+ * @brief The KeepLearned class - learned clauses are never deleted.
+ */
+class KeepLearned {
+public:
+    bool shouldReduce(std::size_t) {
+        return false;
+    }
+
+    bool keep(const Clause &) const {
+        return true;
+    }
+};
+
+
+/**
+ * @brief The SizeBoundedDeletion class - when number of learned clauses reaches the limit, learned clauses longer than MaxKeptSize
+ * are deleted, and the limit is increased.
+ */
+class SizeBoundedDeletion {
+public:
+    bool shouldReduce(std::size_t nLearned) {
+        if (nLearned < _limit){
+            return false;
+        }
+        _limit += _limit / 2;
+        return true;
+    }
+
+    bool keep(const Clause &learned) const {
+        return learned.size() <= MaxKeptSize;
+    }
+
+private:
+    static constexpr std::size_t MaxKeptSize = 8;
+
+    std::size_t _limit = 2000;
+};
+
+
+/**
+ * @brief The FirstUIP class - first unique implication point strategy. The learning process is terminated
+ * when the backjump clause contains exactly one literal from the current decision level.
+ */
+class FirstUIP {
+public:
+    bool isDone(const Clause &, const PartialValuation &, int nTopLevelLiterals) const {
+        return nTopLevelLiterals != -1 && nTopLevelLiterals <= 1;
+    }
+
+    void nextLiteral(const Clause &invertedConflict, const PartialValuation &valuation, Literal &lit) const {
+        bool empty;
+        valuation.lastAssertedLiteral(invertedConflict, lit, empty);
+    }
+};
+
+
+/**
+ * @brief The DecisionScheme class - propagated literals are resolved out until backjump clause contains only decided literals.
+ */
+class DecisionScheme {
+public:
+    bool isDone(const Clause &invertedConflict, const PartialValuation &valuation, int) const {
+        Literal lit;
+        bool empty;
+        valuation.lastPropagatedLiteral(invertedConflict, lit, empty);
+        return empty;
+    }
+
+    void nextLiteral(const Clause &invertedConflict, const PartialValuation &valuation, Literal &lit) const {
+        bool empty;
+        valuation.lastPropagatedLiteral(invertedConflict, lit, empty);
+    }
+};
+
+
+/*
+    Configurations of BasicSolver
+*/
+
+/**
+ * @brief The DefaultPolicies struct - lexicographic decisions, restarts only on backjump to start, no deletion, first UIP.
+ */
+struct DefaultPolicies {
+    using Decision = LexicographicDecision;
+    using Restart = NoRestarts;
+    using Deletion = KeepLearned;
+    using Analysis = FirstUIP;
+};
+
+/**
+ * @brief The ActivityPolicies struct - activity based decisions, Luby restarts, deletion of long learned clauses, first UIP.
+ */
+struct ActivityPolicies {
+    using Decision = ActivityDecision;
+    using Restart = LubyRestarts;
+    using Deletion = SizeBoundedDeletion;
+    using Analysis = FirstUIP;
+};
+
+/**
+ * @brief The DecisionSchemePolicies struct - default policies, but learning with decision scheme.
+ */
+struct DecisionSchemePolicies {
+    using Decision = LexicographicDecision;
+    using Restart = NoRestarts;
+    using Deletion = KeepLearned;
+    using Analysis = DecisionScheme;
+};
+
+#endif // SOLVER_POLICIES_H